@@ -0,0 +1,112 @@
+#include <iostream>
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// Packs every image the game uses into one RGBA atlas and writes it, already
+// decoded, together with font.ttf into a C++ header. The game then needs no
+// files from the working directory to draw itself.
+
+#define ATLAS_WIDTH 512
+
+// Order matters: the game indexes number_1..number_8 as one contiguous range.
+const char *ASSET_NAMES[] = {
+    "digits",
+    "tile_hidden", "tile_revealed", "flag", "mine",
+    "number_1", "number_2", "number_3", "number_4",
+    "number_5", "number_6", "number_7", "number_8",
+    "face_happy", "face_win", "face_lose",
+    "debug", "pause", "play", "leaderboard",
+};
+
+void WriteBytes(std::ofstream &os, const unsigned char *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        os << (int)data[i] << ',';
+        if (i % 32 == 31)
+            os << '\n';
+    }
+    os << '\n';
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: bake_assets <output header>" << std::endl;
+        return 1;
+    }
+    int count = sizeof(ASSET_NAMES) / sizeof(ASSET_NAMES[0]);
+    std::vector<sf::Image> images(count);
+    std::vector<sf::IntRect> rects(count);
+
+    // Shelf packing in list order: good enough for ~20 small images.
+    int x = 0, y = 0, shelfHeight = 0;
+    for (int i = 0; i < count; i++) {
+        std::string file = std::string("./images/") + ASSET_NAMES[i] + ".png";
+        if (!images[i].loadFromFile(file)) {
+            std::cerr << "Error: " << file << " cannot be loaded" << std::endl;
+            return 1;
+        }
+        int w = images[i].getSize().x;
+        int h = images[i].getSize().y;
+        if (x + w > ATLAS_WIDTH) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        rects[i] = sf::IntRect(x, y, w, h);
+        x += w;
+        shelfHeight = std::max(shelfHeight, h);
+    }
+    int atlasHeight = y + shelfHeight;
+
+    sf::Image atlas;
+    atlas.create(ATLAS_WIDTH, atlasHeight, sf::Color::Transparent);
+    for (int i = 0; i < count; i++)
+        atlas.copy(images[i], rects[i].left, rects[i].top);
+
+    std::ifstream fontFile("font.ttf", std::ios::binary);
+    if (!fontFile) {
+        std::cerr << "Error: font.ttf cannot be loaded" << std::endl;
+        return 1;
+    }
+    std::vector<unsigned char> font((std::istreambuf_iterator<char>(fontFile)), std::istreambuf_iterator<char>());
+
+    std::ofstream os(argv[1]);
+    if (!os) {
+        std::cerr << "Error: " << argv[1] << " cannot be written" << std::endl;
+        return 1;
+    }
+    os << "// Generated by bake_assets from images/ and font.ttf. Do not edit.\n";
+    os << "#pragma once\n\n";
+    os << "enum AssetId {\n";
+    for (int i = 0; i < count; i++) {
+        std::string name = ASSET_NAMES[i];
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        os << "    ASSET_" << name << ",\n";
+    }
+    os << "    ASSET_COUNT\n};\n\n";
+
+    os << "const unsigned ATLAS_WIDTH = " << ATLAS_WIDTH << ";\n";
+    os << "const unsigned ATLAS_HEIGHT = " << atlasHeight << ";\n\n";
+    os << "const int ATLAS_RECTS[ASSET_COUNT][4] = {\n";
+    for (int i = 0; i < count; i++)
+        os << "    {" << rects[i].left << ", " << rects[i].top << ", "
+           << rects[i].width << ", " << rects[i].height << "},\n";
+    os << "};\n\n";
+
+    os << "const unsigned char ATLAS_PIXELS[] = {\n";
+    WriteBytes(os, atlas.getPixelsPtr(), ATLAS_WIDTH * atlasHeight * 4);
+    os << "};\n\n";
+
+    os << "const unsigned long FONT_SIZE = " << font.size() << ";\n";
+    os << "const unsigned char FONT_DATA[] = {\n";
+    WriteBytes(os, font.data(), font.size());
+    os << "};\n";
+    os.close();
+    if (!os) {
+        std::cerr << "Error: " << argv[1] << " cannot be written" << std::endl;
+        return 1;
+    }
+    return 0;
+}
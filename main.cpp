@@ -8,9 +8,121 @@
 #include <vector>
 #include <numeric>
 #include <string>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <cstdio>
+#include <cmath>
+#include "assets.h"
 using namespace std::chrono;
 
 #define MAX_CHARACTERS  10
+#define STARTUP_BUDGET_MS  100
+#define GAMES_DIRECTORY  "games"
+#define MAX_GAME_CELLS  (1 << 24)
+#define MINIMAP_SIZE  160
+#define MINIMAP_MARGIN  8
+#define SCREEN_MARGIN  80
+
+// Measures cold start from static initialisation (the closest portable point to
+// process start) to the first frame on screen, phase by phase.
+class StartupTimer {
+    private:
+        time_point<high_resolution_clock> start, last;
+        std::string phases;
+        bool finished;
+    public:
+        StartupTimer(): start(high_resolution_clock::now()), last(start), finished(false) {
+        }
+
+        void mark(std::string phase) {
+            auto now = high_resolution_clock::now();
+            phases += " " + phase + "=" + std::to_string(duration_cast<microseconds>(now - last).count() / 1000.0) + "ms";
+            last = now;
+        }
+
+        void finish() {
+            if (finished) return;
+            finished = true;
+            mark("first_display");
+            double total = duration_cast<microseconds>(last - start).count() / 1000.0;
+            std::cerr << "Startup:" << phases << " total=" << total << "ms";
+            if (total > STARTUP_BUDGET_MS)
+                std::cerr << " (over " << STARTUP_BUDGET_MS << "ms budget)";
+            std::cerr << std::endl;
+        }
+};
+StartupTimer startupTimer;
+
+sf::IntRect AssetRect(int id) {
+    return sf::IntRect(ATLAS_RECTS[id][0], ATLAS_RECTS[id][1], ATLAS_RECTS[id][2], ATLAS_RECTS[id][3]);
+}
+
+// Everything the game draws, baked into the binary by bake_assets: one atlas
+// uploaded with a single call and the font read straight from memory. Needs a
+// display: constructing the first sf::Texture opens SFML's shared GL context.
+class Assets {
+    public:
+        sf::Texture atlas;
+        sf::Font font;
+        Assets() {
+            atlas.create(ATLAS_WIDTH, ATLAS_HEIGHT);
+            atlas.update(ATLAS_PIXELS);
+            font.loadFromMemory(FONT_DATA, FONT_SIZE);
+        }
+};
+
+// Stands in for a RenderWindow when rendering without a display: draws the
+// Board's sprites and buttons by copying their rects out of the CPU-side atlas.
+// Every board element is an unscaled atlas rect, so copying is exact. Uses no
+// sf::Texture, so it works where no GL context can be created.
+class ImageTarget {
+    private:
+        sf::Image atlas;
+    public:
+        sf::Image frame;
+
+        ImageTarget() {
+            atlas.create(ATLAS_WIDTH, ATLAS_HEIGHT, ATLAS_PIXELS);
+        }
+
+        void clear(unsigned width, unsigned height, sf::Color color) {
+            frame.create(width, height, color);
+        }
+
+        // Clips to the frame like a window would: panel elements can sit at a
+        // negative x on narrow boards, and sf::Image::copy takes unsigned.
+        void blit(sf::Vector2f position, sf::IntRect source) {
+            int x = std::floor(position.x), y = std::floor(position.y);
+            if (x < 0) {
+                source.left -= x;
+                source.width += x;
+                x = 0;
+            }
+            if (y < 0) {
+                source.top -= y;
+                source.height += y;
+                y = 0;
+            }
+            source.width = std::min(source.width, (int)frame.getSize().x - x);
+            source.height = std::min(source.height, (int)frame.getSize().y - y);
+            if (source.width <= 0 || source.height <= 0) return;
+            frame.copy(atlas, x, y, source, true);
+        }
+
+        void draw(const sf::Sprite &sprite) {
+            blit(sprite.getPosition(), sprite.getTextureRect());
+        }
+
+        void draw(const sf::RectangleShape &shape) {
+            blit(shape.getPosition(), shape.getTextureRect());
+        }
+};
 
 class Board;
 class boardMap {
@@ -24,6 +136,16 @@ class boardMap {
             number = std::vector<std::vector<int>> (numRow, std::vector<int> (numCol, 0));
         }
 
+        // Layout from a recorded game, as mine indices (row * numCol + col).
+        void LoadMineMap(const std::vector<int> &mines) {
+            for (int i = 0; i < numRow; i++)
+                for (int j = 0; j < numCol; j++)
+                    mine[i][j] = number[i][j] = 0;
+            for (int m : mines)
+                mine[m / numCol][m % numCol] = 1;
+            CountNumbers();
+        }
+
         void RandomMineMap() {
             std::vector<int> permutation(numCol * numRow);
             std::iota(permutation.begin(), permutation.end(), 0);
@@ -38,6 +160,10 @@ class boardMap {
                 int col = permutation[i] % numCol;
                 mine[row][col] = 1;
             }
+            CountNumbers();
+        }
+
+        void CountNumbers() {
             for (int i = 0; i < numRow; i++)
             for (int j = 0; j < numCol; j++)
                 if (mine[i][j])
@@ -136,7 +262,221 @@ class Leaderboard {
 
 };
 
-int LeaderboardWindowProcess(int width, int height, int, std::string);
+// A finished game as saved to games/: the mine layout plus every click, so it
+// can be analysed or replayed later. Text format:
+//   numCol numRow numMine won
+//   mine indices (row * numCol + col)
+//   one "O|F row col milliseconds" line per open or flag
+class GameLog {
+    public:
+        struct Action {
+            char type;
+            int row, col, timeMs;
+        };
+        int numCol, numRow, numMine, won;
+        std::vector<int> mines;
+        std::vector<Action> actions;
+    private:
+        // Scratch for parse() to reject a mine listed twice.
+        std::vector<char> seen;
+    public:
+
+        void reset(int numCol, int numRow, const std::vector<std::vector<int>> &mine) {
+            this->numCol = numCol;
+            this->numRow = numRow;
+            won = 0;
+            mines.clear();
+            actions.clear();
+            for (int i = 0; i < numRow; i++)
+                for (int j = 0; j < numCol; j++)
+                    if (mine[i][j])
+                        mines.push_back(i * numCol + j);
+            numMine = mines.size();
+        }
+
+        void add(char type, int row, int col, int timeMs) {
+            actions.push_back({type, row, col, timeMs});
+        }
+
+        void save(std::string playerName) {
+            std::filesystem::create_directories(GAMES_DIRECTORY);
+            long long stamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+            std::ofstream os;
+            os.open(std::string(GAMES_DIRECTORY) + "/" + std::to_string(stamp) + "_" + playerName + ".game");
+            os << numCol << ' ' << numRow << ' ' << numMine << ' ' << won << '\n';
+            for (int i = 0; i < numMine; i++)
+                os << mines[i] << (i + 1 < numMine ? ' ' : '\n');
+            for (auto &a : actions)
+                os << a.type << ' ' << a.row << ' ' << a.col << ' ' << a.timeMs << '\n';
+            os.close();
+        }
+
+        // Hand-rolled so the batch analyzer is not bottlenecked on iostreams.
+        // Reuses the vectors' capacity when called repeatedly.
+        bool parse(const char *p, const char *end) {
+            auto readInt = [&](int &value) {
+                while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+                if (p == end || *p < '0' || *p > '9') return false;
+                value = 0;
+                // Nine digits always fit in an int; anything longer is rejected.
+                for (int digits = 0; p < end && *p >= '0' && *p <= '9'; digits++) {
+                    if (digits == 9) return false;
+                    value = value * 10 + (*p++ - '0');
+                }
+                return true;
+            };
+            if (!readInt(numCol) || !readInt(numRow) || !readInt(numMine) || !readInt(won))
+                return false;
+            if (numCol <= 0 || numRow <= 0 || (long long)numCol * numRow > MAX_GAME_CELLS || numMine > numCol * numRow)
+                return false;
+            mines.resize(numMine);
+            seen.assign(numCol * numRow, 0);
+            for (int i = 0; i < numMine; i++) {
+                if (!readInt(mines[i]) || mines[i] >= numCol * numRow || seen[mines[i]])
+                    return false;
+                seen[mines[i]] = 1;
+            }
+            actions.clear();
+            while (true) {
+                while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+                if (p == end) break;
+                Action a;
+                a.type = *p++;
+                if (a.type != 'O' && a.type != 'F')
+                    return false;
+                if (!readInt(a.row) || !readInt(a.col) || !readInt(a.timeMs))
+                    return false;
+                if (a.row >= numRow || a.col >= numCol)
+                    return false;
+                actions.push_back(a);
+            }
+            return true;
+        }
+};
+
+// Overview of boards larger than the window: one pixel per region of cells, or
+// a small block per cell on smaller boards. Cells are pushed in as they change
+// and only the touched rectangle is re-uploaded, so a frame costs the same on
+// any board size.
+class Minimap {
+    private:
+        int numCol, numRow, region, block, width, height;
+        std::vector<sf::Uint8> pixels, scratch;
+        std::vector<int> cellKind;
+        std::vector<std::vector<int>> regionCount;
+        int dirtyLeft, dirtyTop, dirtyRight, dirtyBottom;
+        sf::Texture texture;
+        sf::Sprite sprite;
+        sf::RectangleShape viewFrame;
+
+        void paintRegion(int r) {
+            const sf::Color COLORS[] = {sf::Color(128, 128, 128), sf::Color(220, 220, 220), sf::Color(220, 40, 40)};
+            std::vector<int> &count = regionCount[r];
+            int total = count[0] + count[1] + count[2];
+            int red = 0, green = 0, blue = 0;
+            for (int k = 0; k < 3; k++) {
+                red += COLORS[k].r * count[k];
+                green += COLORS[k].g * count[k];
+                blue += COLORS[k].b * count[k];
+            }
+            int regionCols = (numCol + region - 1) / region;
+            int x0 = r % regionCols * block;
+            int y0 = r / regionCols * block;
+            for (int y = y0; y < y0 + block; y++)
+                for (int x = x0; x < x0 + block; x++) {
+                    sf::Uint8 *px = &pixels[(y * width + x) * 4];
+                    px[0] = red / total;
+                    px[1] = green / total;
+                    px[2] = blue / total;
+                    px[3] = 255;
+                }
+            dirtyLeft = std::min(dirtyLeft, x0);
+            dirtyTop = std::min(dirtyTop, y0);
+            dirtyRight = std::max(dirtyRight, x0 + block);
+            dirtyBottom = std::max(dirtyBottom, y0 + block);
+        }
+
+    public:
+        // Kinds of cell the minimap tells apart.
+        static constexpr int HIDDEN = 0;
+        static constexpr int OPENED = 1;
+        static constexpr int FLAGED = 2;
+
+        void reset(int numCol, int numRow) {
+            this->numCol = numCol;
+            this->numRow = numRow;
+            region = (std::max(numCol, numRow) + MINIMAP_SIZE - 1) / MINIMAP_SIZE;
+            block = (region == 1) ? std::max(1, std::min(4, MINIMAP_SIZE / std::max(numCol, numRow))) : 1;
+            int regionCols = (numCol + region - 1) / region;
+            int regionRows = (numRow + region - 1) / region;
+            width = regionCols * block;
+            height = regionRows * block;
+            pixels.assign(width * height * 4, 0);
+            cellKind.assign(numCol * numRow, HIDDEN);
+            regionCount.assign(regionCols * regionRows, std::vector<int> (3, 0));
+            for (int i = 0; i < numRow; i++)
+                for (int j = 0; j < numCol; j++)
+                    regionCount[i / region * regionCols + j / region][HIDDEN]++;
+            dirtyLeft = width, dirtyTop = height, dirtyRight = 0, dirtyBottom = 0;
+            for (int r = 0; r < regionCount.size(); r++)
+                paintRegion(r);
+            texture.create(width, height);
+            sprite.setTexture(texture, true);
+            viewFrame.setFillColor(sf::Color::Transparent);
+            viewFrame.setOutlineColor(sf::Color::Yellow);
+            viewFrame.setOutlineThickness(1);
+        }
+
+        void setCell(int id, int kind) {
+            if (cellKind[id] == kind) return;
+            int regionCols = (numCol + region - 1) / region;
+            int r = id / numCol / region * regionCols + id % numCol / region;
+            regionCount[r][cellKind[id]]--;
+            regionCount[r][kind]++;
+            cellKind[id] = kind;
+            paintRegion(r);
+        }
+
+        void setPosition(float x, float y) {
+            sprite.setPosition(x, y);
+        }
+
+        // Pushes the rectangle touched since the last call to the GPU.
+        void upload() {
+            if (dirtyLeft >= dirtyRight) return;
+            int w = dirtyRight - dirtyLeft, h = dirtyBottom - dirtyTop;
+            scratch.resize(w * h * 4);
+            for (int y = 0; y < h; y++)
+                std::copy_n(&pixels[((dirtyTop + y) * width + dirtyLeft) * 4], w * 4, &scratch[y * w * 4]);
+            texture.update(scratch.data(), w, h, dirtyLeft, dirtyTop);
+            dirtyLeft = width, dirtyTop = height, dirtyRight = 0, dirtyBottom = 0;
+        }
+
+        void draw(sf::RenderWindow &window, int viewLeft, int viewTop, int viewCols, int viewRows) {
+            float scale = (float)block / region;
+            viewFrame.setPosition(sprite.getPosition().x + viewLeft * scale, sprite.getPosition().y + viewTop * scale);
+            viewFrame.setSize(sf::Vector2f(viewCols * scale, viewRows * scale));
+            window.draw(sprite);
+            window.draw(viewFrame);
+        }
+
+        bool contains(int xPos, int yPos) {
+            int x = xPos - sprite.getPosition().x, y = yPos - sprite.getPosition().y;
+            return x >= 0 && y >= 0 && x < width && y < height;
+        }
+
+        // Board cell under a point of the minimap, as (col, row).
+        sf::Vector2i cellAt(int xPos, int yPos) {
+            int x = xPos - sprite.getPosition().x, y = yPos - sprite.getPosition().y;
+            return sf::Vector2i(std::min(x / block * region, numCol - 1), std::min(y / block * region, numRow - 1));
+        }
+
+        int getWidth() {
+            return width;
+        }
+};
+
+int LeaderboardWindowProcess(const Assets &, int width, int height, int, std::string);
 class Board {
     private:
         const int NOTOPEN = 0;
@@ -145,11 +485,15 @@ class Board {
         const int DEBUG = 3;
         boardMap state;
         std::string playerName;
+        // Null for headless boards, which must not touch any sf::Texture.
+        const Assets *assets;
+        GameLog log;
+        std::unique_ptr<Minimap> minimap;
         std::vector<sf::Sprite> cells;
-        std::vector<sf::Texture> cellTextures;
+        std::vector<sf::IntRect> cellTextures;
 
         std::vector<sf::Sprite> icons;
-        std::vector<sf::Texture> iconTextures;
+        std::vector<sf::IntRect> iconTextures;
 
         std::vector<sf::Sprite> flagCounters;
         std::vector<sf::IntRect> flagCounterTextures;
@@ -160,21 +504,48 @@ class Board {
         std::vector<int> gameState;
 
         sf::RectangleShape faceButton, debugButton, playPauseButton, leaderboardButton;
-        sf::Texture faceTexture, debugTexture, playPauseTexture, leaderboardTexture;
-        
-        sf::Texture digitsTexture, tileHiddenTexture, tileRevealedTexture;
 
         time_point<high_resolution_clock> current, lastPlay; 
         duration<double> totalTime; 
 
         int timeCounter, flagCounter, tileCounter;
         int isWin, isPause, isDebugging, isFirstAction, isLeaderboardAfterWin;
+        int isReplay;
+        // Games where the mines were shown are not saved for analysis.
+        int isDebugUsed;
+
+        // Part of the board on screen, in cells. The whole board unless it is
+        // larger than the screen, in which case the minimap is shown too.
+        int viewCols, viewRows, viewLeft, viewTop;
+
+        bool hasMinimap() {
+            return viewCols < state.numCol || viewRows < state.numRow;
+        }
+
+        void setState(int id, int s) {
+            if (gameState[id] == s) return;
+            gameState[id] = s;
+            if (minimap)
+                minimap->setCell(id, s == OPENED ? Minimap::OPENED : s == FLAGED ? Minimap::FLAGED : Minimap::HIDDEN);
+        }
 
     public:
-        Board(boardMap state, std::string playerName) : state(state), playerName(playerName) {
-            digitsTexture.loadFromFile("./images/digits.png");
-            tileHiddenTexture.loadFromFile("./images/tile_hidden.png");
-            tileRevealedTexture.loadFromFile("./images/tile_revealed.png");
+        Board(boardMap state, std::string playerName, const Assets &assets) : state(state), playerName(playerName), assets(&assets) {
+            viewCols = state.numCol;
+            viewRows = state.numRow;
+            isReplay = 0;
+        }
+
+        // Headless board: sprites only carry atlas rects, for an ImageTarget.
+        Board(boardMap state) : state(state), assets(nullptr) {
+            viewCols = state.numCol;
+            viewRows = state.numRow;
+            isReplay = 0;
+        }
+
+        void setViewSize(int cols, int rows) {
+            viewCols = std::min(cols, state.numCol);
+            viewRows = std::min(rows, state.numRow);
         }
 
         void init() {
@@ -197,64 +568,76 @@ class Board {
                     int xPos = j * 32;
                     int id = i * state.numCol + j;
 
-                    cellTextures[id].loadFromFile("./images/tile_hidden.png");
-                    cells[id].setTexture(cellTextures[id]);
+                    cellTextures[id] = AssetRect(ASSET_TILE_HIDDEN);
+                    if (assets) cells[id].setTexture(assets->atlas);
+                    cells[id].setTextureRect(cellTextures[id]);
                     cells[id].setPosition(xPos, yPos);
 
-                    iconTextures[id].loadFromFile("./images/tile_revealed.png");
-                    icons[id].setTexture(iconTextures[id]);
+                    iconTextures[id] = AssetRect(ASSET_TILE_REVEALED);
+                    if (assets) icons[id].setTexture(assets->atlas);
+                    icons[id].setTextureRect(iconTextures[id]);
                     icons[id].setPosition(xPos, yPos);
                 }
             }
 
-            int width = state.numCol;
-            int height = state.numRow;
+            viewLeft = viewTop = 0;
+            if (hasMinimap() && assets) {
+                if (!minimap)
+                    minimap = std::make_unique<Minimap>();
+                minimap->reset(state.numCol, state.numRow);
+                // In its own column right of the board, so it never hides cells.
+                minimap->setPosition(viewCols * 32 + MINIMAP_MARGIN, MINIMAP_MARGIN);
+            }
+
+            int width = viewCols;
+            int height = viewRows;
 
             for (int i = 0; i < 3; i++) {
                 flagCounterTextures[i].height = 32;
                 flagCounterTextures[i].width = 21;
-                flagCounterTextures[i].top = 0;
+                flagCounterTextures[i].top = AssetRect(ASSET_DIGITS).top;
+                if (assets) flagCounters[i].setTexture(assets->atlas);
                 flagCounters[i].setTextureRect(flagCounterTextures[i]);
                 flagCounters[i].setPosition(sf::Vector2f(33 + 21 * i, 32 * (height+0.5f)+16));
-                flagCounters[i].setTexture(digitsTexture);
             }
 
             for (int i = 0; i < 2; i++) {
                 timeCounterTextures[i].height = 32;
                 timeCounterTextures[i].width = 21;
-                timeCounterTextures[i].top = 0;
+                timeCounterTextures[i].top = AssetRect(ASSET_DIGITS).top;
+                if (assets) timeCounters[i].setTexture(assets->atlas);
                 timeCounters[i].setTextureRect(timeCounterTextures[i]);
                 timeCounters[i].setPosition(sf::Vector2f((width * 32) - 97 + 21 * i, 32 * (height + 0.5f) + 16));
-                timeCounters[i].setTexture(digitsTexture);
             }
 
             for (int i = 2; i < 4; i++) {
                 timeCounterTextures[i].height = 32;
                 timeCounterTextures[i].width = 21;
+                timeCounterTextures[i].top = AssetRect(ASSET_DIGITS).top;
+                if (assets) timeCounters[i].setTexture(assets->atlas);
                 timeCounters[i].setTextureRect(timeCounterTextures[i]);
                 timeCounters[i].setPosition(sf::Vector2f((width * 32) - 54 + 21 * (i - 2), 32 * (height + 0.5f) + 16));
-                timeCounters[i].setTexture(digitsTexture);
             }
 
-            faceTexture.loadFromFile("./images/face_happy.png");
             faceButton.setSize(sf::Vector2f(64, 64));
-            faceButton.setTexture(&faceTexture);
+            faceButton.setTexture(assets ? &assets->atlas : nullptr);
+            faceButton.setTextureRect(AssetRect(ASSET_FACE_HAPPY));
             faceButton.setPosition(sf::Vector2f(((width / 2.0) * 32) - 32, 32 *(height+0.5f)));
 
-            debugTexture.loadFromFile("./images/debug.png");
             debugButton.setSize(sf::Vector2f(64, 64));
             debugButton.setPosition(sf::Vector2f((width * 32) - 304, 32 * (height+0.5f)));
-            debugButton.setTexture(&debugTexture);
+            debugButton.setTexture(assets ? &assets->atlas : nullptr);
+            debugButton.setTextureRect(AssetRect(ASSET_DEBUG));
 
-            playPauseTexture.loadFromFile("./images/pause.png");
             playPauseButton.setSize(sf::Vector2f(64, 64));
             playPauseButton.setPosition(sf::Vector2f((width * 32) - 240, 32 * (height+0.5f)));
-            playPauseButton.setTexture(&playPauseTexture);
+            playPauseButton.setTexture(assets ? &assets->atlas : nullptr);
+            playPauseButton.setTextureRect(AssetRect(ASSET_PAUSE));
 
-            leaderboardTexture.loadFromFile("./images/leaderboard.png");
             leaderboardButton.setSize(sf::Vector2f(64, 64));
             leaderboardButton.setPosition(sf::Vector2f((width * 32) - 176, 32 * (height+0.5f)));
-            leaderboardButton.setTexture(&leaderboardTexture);   
+            leaderboardButton.setTexture(assets ? &assets->atlas : nullptr);
+            leaderboardButton.setTextureRect(AssetRect(ASSET_LEADERBOARD));
 
             flagCounter = state.numMine;
             tileCounter = state.numRow * state.numCol - state.numMine;
@@ -262,10 +645,38 @@ class Board {
             isWin = 0;
             isPause = 0;
             isDebugging = 0;
+            isDebugUsed = 0;
             isFirstAction = 1;
             isLeaderboardAfterWin = 0;
             totalTime = duration_cast<duration<double>>(
                 high_resolution_clock::now() - high_resolution_clock::now());
+            log.reset(state.numCol, state.numRow, state.mine);
+        }
+
+        // Replays drive the clock from the recording instead of the wall clock,
+        // and are not recorded again.
+        void setReplayTime(int timeMs) {
+            isReplay = 1;
+            totalTime = duration<double>(timeMs / 1000.0);
+        }
+
+        int elapsedMs() {
+            duration<double> elapsed = totalTime;
+            if (isPause == 0 && !isFirstAction && isWin == 0 && !isReplay)
+                elapsed += duration_cast<duration<double>>(high_resolution_clock::now() - lastPlay);
+            return elapsed.count() * 1000;
+        }
+
+        void scroll(int dCol, int dRow) {
+            viewLeft = std::max(0, std::min(viewLeft + dCol, state.numCol - viewCols));
+            viewTop = std::max(0, std::min(viewTop + dRow, state.numRow - viewRows));
+        }
+
+        void minimapJump(int xPos, int yPos) {
+            // Hidden while paused, like in PrintBoard.
+            if (!minimap || isPause || !minimap->contains(xPos, yPos)) return;
+            sf::Vector2i cell = minimap->cellAt(xPos, yPos);
+            scroll(cell.x - viewCols / 2 - viewLeft, cell.y - viewRows / 2 - viewTop);
         }
 
         void debug(int xPos, int yPos) {
@@ -276,16 +687,18 @@ class Board {
             
             if (debugButton.getGlobalBounds().contains(sf::Vector2f(xPos, yPos))) {
                 isDebugging = 1 - isDebugging;
+                if (isDebugging)
+                    isDebugUsed = 1;
                 for (int i = 0; i < gameState.size(); i++) 
                 if (state.mine[i / state.numCol][i % state.numCol]) {
                     if (isDebugging) {
                         if (gameState[i] == FLAGED)
                             flagCounter++;
-                        gameState[i] = DEBUG;
-                        iconTextures[i].loadFromFile("./images/mine.png");
+                        setState(i, DEBUG);
+                        iconTextures[i] = AssetRect(ASSET_MINE);
                     } else 
                         if (gameState[i] == DEBUG)
-                            gameState[i] = NOTOPEN;                    
+                            setState(i, NOTOPEN);                    
                 }
             }
 
@@ -301,23 +714,23 @@ class Board {
         void pause(int xPos, int yPos, int force = 0) {
             if (playPauseButton.getGlobalBounds().contains(sf::Vector2f(xPos, yPos)) && isWin == 0) {
                 if (isPause) {
-                    playPauseTexture.loadFromFile("./images/pause.png");
+                    playPauseButton.setTextureRect(AssetRect(ASSET_PAUSE));
                     isPause = 0;
                     lastPlay = high_resolution_clock::now();
                 } else {
-                    playPauseTexture.loadFromFile("./images/play.png");
+                    playPauseButton.setTextureRect(AssetRect(ASSET_PLAY));
                     isPause = 1;
                     current = high_resolution_clock::now();
                     totalTime += duration_cast<duration<double>>(current - lastPlay);
                 }
             }
             if (force == 1 && isPause == 0) {
-                playPauseTexture.loadFromFile("./images/play.png");
+                playPauseButton.setTextureRect(AssetRect(ASSET_PLAY));
                 isPause = 2;
                 current = high_resolution_clock::now();
                 totalTime += duration_cast<duration<double>>(current - lastPlay);
             } else if (force == 1 && isPause == 2) {
-                playPauseTexture.loadFromFile("./images/pause.png");
+                playPauseButton.setTextureRect(AssetRect(ASSET_PAUSE));
                 isPause = 0;
                 lastPlay = high_resolution_clock::now();
             }
@@ -331,7 +744,8 @@ class Board {
                 return false;
         }
 
-        void drawFlag(sf::RenderWindow &window) {
+        template <class Target>
+        void drawFlag(Target &window) {
             int digits[3];
             // std::cerr << flagCounter << "\n";
             if (flagCounter < 0) 
@@ -344,15 +758,16 @@ class Board {
             digits[2] = temp % 10;
 
             for (int i = 0; i < 3; i++) {
-                flagCounterTextures[i].left = 21 * digits[i];
+                flagCounterTextures[i].left = AssetRect(ASSET_DIGITS).left + 21 * digits[i];
                 flagCounters[i].setTextureRect(flagCounterTextures[i]);
                 window.draw(flagCounters[i]);
             }
         }
 
-        void drawTime(sf::RenderWindow &window) {
+        template <class Target>
+        void drawTime(Target &window) {
             int digits[4];
-            if (isPause == 0 && !isFirstAction && isWin == 0) {
+            if (isPause == 0 && !isFirstAction && isWin == 0 && !isReplay) {
                 current = high_resolution_clock::now();
                 duration<double> moreTime = duration_cast<duration<double>>(current - lastPlay);
                 timeCounter = totalTime.count() + moreTime.count();
@@ -365,67 +780,103 @@ class Board {
             digits[2] = temp % 60 / 10;
             digits[3] = temp % 60 % 10;
             for (int i = 0; i < 4; i++) {
-                timeCounterTextures[i].left = 21 * digits[i];
+                timeCounterTextures[i].left = AssetRect(ASSET_DIGITS).left + 21 * digits[i];
                 timeCounters[i].setTextureRect(timeCounterTextures[i]);
                 window.draw(timeCounters[i]);
             }
             return;
         }
 
-        void PrintBoard(sf::RenderWindow &window) {
-            window.clear(sf::Color::White);
+        void updateEnding() {
             if (isWin == 1) {
                 flagCounter = 0;
                 for (int i = 0; i < cells.size(); i++)
                     if (gameState[i] == NOTOPEN || gameState[i] == DEBUG) {
-                        iconTextures[i].loadFromFile("./images/flag.png");
-                        gameState[i] = FLAGED;
+                        iconTextures[i] = AssetRect(ASSET_FLAG);
+                        setState(i, FLAGED);
                     }
-                faceTexture.loadFromFile("./images/face_win.png");
+                faceButton.setTextureRect(AssetRect(ASSET_FACE_WIN));
             } else if (isWin == -1) {
                 for (int i = 0; i < cells.size(); i++) {
                     int r = i / state.numCol;
                     int c = i % state.numCol;
                     if (state.mine[r][c]) {
-                        gameState[i] = OPENED;
-                        cellTextures[i].loadFromFile("./images/tile_revealed.png");
-                        iconTextures[i].loadFromFile("./images/mine.png");
+                        setState(i, OPENED);
+                        cellTextures[i] = AssetRect(ASSET_TILE_REVEALED);
+                        iconTextures[i] = AssetRect(ASSET_MINE);
                     }
                 }
-                faceTexture.loadFromFile("./images/face_lose.png");
+                faceButton.setTextureRect(AssetRect(ASSET_FACE_LOSE));
             }
-            if (isPause) 
-                for (int i = 0; i < cells.size(); i++)
-                    cells[i].setTexture(tileRevealedTexture);
-            else 
-                for (int i = 0; i < cells.size(); i++)
-                    cells[i].setTexture(cellTextures[i]);
-            
-            for (int i = 0; i < cells.size(); i++) {
+        }
+
+        template <class Target>
+        void drawCells(Target &window) {
+            for (int r = viewTop; r < viewTop + viewRows; r++)
+            for (int c = viewLeft; c < viewLeft + viewCols; c++) {
+                int i = r * state.numCol + c;
+                cells[i].setTextureRect(isPause ? AssetRect(ASSET_TILE_REVEALED) : cellTextures[i]);
+                icons[i].setTextureRect(iconTextures[i]);
                 window.draw(cells[i]);
                 if (gameState[i] != NOTOPEN && isPause == 0) {
                     window.draw(icons[i]);
                 }
             }
+        }
+
+        template <class Target>
+        void drawPanel(Target &window) {
             window.draw(faceButton);
             window.draw(debugButton);
             window.draw(playPauseButton);
             window.draw(leaderboardButton);
             drawFlag(window);
             drawTime(window);
+        }
+
+        void PrintBoard(sf::RenderWindow &window) {
+            window.clear(sf::Color::White);
+            updateEnding();
+            // Only the cells in view are drawn, through a view scrolled to them.
+            sf::View boardView(sf::FloatRect(viewLeft * 32, viewTop * 32, viewCols * 32, viewRows * 32));
+            boardView.setViewport(sf::FloatRect(0, 0, viewCols * 32.0f / window.getSize().x, viewRows * 32.0f / window.getSize().y));
+            window.setView(boardView);
+            drawCells(window);
+            window.setView(window.getDefaultView());
+            if (minimap && isPause == 0) {
+                minimap->upload();
+                minimap->draw(window, viewLeft, viewTop, viewCols, viewRows);
+            }
+            drawPanel(window);
             window.display();
             if (isWin == 1 && isLeaderboardAfterWin == 0) {
                 isLeaderboardAfterWin = 1;
-                LeaderboardWindowProcess(window.getSize().x, window.getSize().y, timeCounter, playerName);;
+                LeaderboardWindowProcess(*assets, window.getSize().x, window.getSize().y, timeCounter, playerName);
             }
             return;
         }
 
+        // Same picture as PrintBoard, without a window or a GL context.
+        void PrintBoard(ImageTarget &target) {
+            target.clear(viewCols * 32, viewRows * 32 + 100, sf::Color::White);
+            updateEnding();
+            drawCells(target);
+            drawPanel(target);
+        }
+
+        void replay(const GameLog::Action &action) {
+            if (action.type == 'O')
+                openCell(action.col * 32 - viewLeft * 32, action.row * 32 - viewTop * 32);
+            else
+                setFlag(action.col * 32 - viewLeft * 32, action.row * 32 - viewTop * 32);
+            setReplayTime(action.timeMs);
+        }
+
         void setFlag(int xPos, int yPos) {
             if (isWin || isPause) return;
             if (xPos < 0 || yPos < 0)
                 return;
-            if (xPos >= 32 * state.numCol || yPos >= 32 * state.numRow)
+            if (xPos >= 32 * viewCols || yPos >= 32 * viewRows)
                 return;
 
             if (isFirstAction) {
@@ -434,23 +885,24 @@ class Board {
             }
             
 
-            int i = yPos / 32;
-            int j = xPos / 32;
+            int i = yPos / 32 + viewTop;
+            int j = xPos / 32 + viewLeft;
             int id = i * state.numCol + j;
             if (gameState[id] == OPENED) 
                 return;
+            log.add('F', i, j, elapsedMs());
             if (gameState[id] == NOTOPEN || gameState[id] == DEBUG) {
-                gameState[id] = FLAGED;
-                iconTextures[id].loadFromFile("./images/flag.png");
+                setState(id, FLAGED);
+                iconTextures[id] = AssetRect(ASSET_FLAG);
                 --flagCounter;
             } else {
                 if (state.mine[i][j] && isDebugging) {
-                    gameState[id] = DEBUG;
-                    iconTextures[id].loadFromFile("./images/mine.png");
+                    setState(id, DEBUG);
+                    iconTextures[id] = AssetRect(ASSET_MINE);
                 }
                 else {
-                    gameState[id] = NOTOPEN;
-                    iconTextures[id].loadFromFile("./images/tile_revealed.png");
+                    setState(id, NOTOPEN);
+                    iconTextures[id] = AssetRect(ASSET_TILE_REVEALED);
                 }
                 ++flagCounter;
             }
@@ -461,7 +913,7 @@ class Board {
             if (isWin || isPause) return;
             if (xPos < 0 || yPos < 0)
                 return;
-            if (xPos >= 32 * state.numCol || yPos >= 32 * state.numRow)
+            if (xPos >= 32 * viewCols || yPos >= 32 * viewRows)
                 return;
 
             if (isFirstAction) {
@@ -469,22 +921,25 @@ class Board {
                 isFirstAction = 0;
             }
 
-            int i = yPos / 32;
-            int j = xPos / 32;
+            int i = yPos / 32 + viewTop;
+            int j = xPos / 32 + viewLeft;
             int id = i * state.numCol + j;
 
             if (gameState[id] == OPENED || gameState[id] == FLAGED)
                 return;
+            log.add('O', i, j, elapsedMs());
 
-            gameState[id] = OPENED;
-            cellTextures[id].loadFromFile("./images/tile_revealed.png");   
+            setState(id, OPENED);
+            cellTextures[id] = AssetRect(ASSET_TILE_REVEALED);
             if (state.mine[i][j]) {
-                iconTextures[id].loadFromFile("./images/mine.png");
+                iconTextures[id] = AssetRect(ASSET_MINE);
                 isWin =  -1;
                 tileCounter++;
                 current = high_resolution_clock::now();
                 duration<double> moreTime = duration_cast<duration<double>>(current - lastPlay);
                 totalTime += moreTime;
+                if (!isReplay && !isDebugUsed)
+                    log.save(playerName);
             }
             else if (state.number[i][j] == 0) {
                 std::vector<std::pair<int, int>> st;
@@ -502,21 +957,19 @@ class Board {
                         if (nc < 0 || nc >= state.numCol) continue;
                         int id = nr * state.numCol + nc;
                         if (gameState[id] != NOTOPEN) continue;
-                        gameState[id] = OPENED;
+                        setState(id, OPENED);
                         tileCounter--;
                         if (state.number[nr][nc] == 0)
                             st.push_back({nr, nc});
                         else {
-                            std::string file = "./images/number_" + std::to_string(state.number[nr][nc]) + ".png";
-                            iconTextures[id].loadFromFile(file.c_str());
-                            cellTextures[id].loadFromFile("./images/tile_revealed.png");
+                            iconTextures[id] = AssetRect(ASSET_NUMBER_1 + state.number[nr][nc] - 1);
+                            cellTextures[id] = AssetRect(ASSET_TILE_REVEALED);
                         }
                     }
                 }
             }
             else {
-                std::string file = "./images/number_" + std::to_string(state.number[i][j]) + ".png";
-                iconTextures[id].loadFromFile(file.c_str());
+                iconTextures[id] = AssetRect(ASSET_NUMBER_1 + state.number[i][j] - 1);
             }
             tileCounter--;
             if (tileCounter == 0) {
@@ -524,6 +977,9 @@ class Board {
                 current = high_resolution_clock::now();
                 duration<double> moreTime = duration_cast<duration<double>>(current - lastPlay);
                 totalTime += moreTime;
+                log.won = 1;
+                if (!isReplay && !isDebugUsed)
+                    log.save(playerName);
             }
         }
 
@@ -539,16 +995,274 @@ void LoadBoardConfig(int &numCol, int &numRow, int &numMine) {
     return;
 }
 
-int LeaderboardWindowProcess(int width, int height, int time = -10, std::string playerName = "") {
+// Board difficulty and player efficiency of one recorded game. 3BV is the
+// minimum number of clicks that clears the board: one per opening (connected
+// zero region) plus one per number not bordering any opening.
+struct GameMetrics {
+    std::string file;
+    int numCol, numRow, numMine, won, clicks, bbbv, openings;
+    double seconds;
+};
+
+void AnalyzeGame(const GameLog &log, std::vector<int> &number, std::vector<char> &covered, std::vector<int> &stack, GameMetrics &metrics) {
+    int numCol = log.numCol, numRow = log.numRow, size = numCol * numRow;
+    number.assign(size, 0);
+    covered.assign(size, 0);
+    for (int m : log.mines)
+        number[m] = -1;
+    for (int m : log.mines) {
+        int r = m / numCol, c = m % numCol;
+        for (int nr = std::max(r - 1, 0); nr <= std::min(r + 1, numRow - 1); nr++)
+        for (int nc = std::max(c - 1, 0); nc <= std::min(c + 1, numCol - 1); nc++)
+            if (number[nr * numCol + nc] >= 0)
+                number[nr * numCol + nc]++;
+    }
+
+    int openings = 0;
+    for (int i = 0; i < size; i++) {
+        if (number[i] != 0 || covered[i]) continue;
+        openings++;
+        covered[i] = 1;
+        stack.push_back(i);
+        while (stack.size()) {
+            int cur = stack.back();
+            stack.pop_back();
+            int r = cur / numCol, c = cur % numCol;
+            for (int nr = std::max(r - 1, 0); nr <= std::min(r + 1, numRow - 1); nr++)
+            for (int nc = std::max(c - 1, 0); nc <= std::min(c + 1, numCol - 1); nc++) {
+                int id = nr * numCol + nc;
+                if (covered[id]) continue;
+                covered[id] = 1;
+                if (number[id] == 0)
+                    stack.push_back(id);
+            }
+        }
+    }
+    int bbbv = openings;
+    for (int i = 0; i < size; i++)
+        if (number[i] > 0 && !covered[i])
+            bbbv++;
+
+    metrics.numCol = numCol;
+    metrics.numRow = numRow;
+    metrics.numMine = log.numMine;
+    metrics.won = log.won;
+    metrics.clicks = log.actions.size();
+    metrics.bbbv = bbbv;
+    metrics.openings = openings;
+    metrics.seconds = log.actions.empty() ? 0 : log.actions.back().timeMs / 1000.0;
+}
+
+// Batch mode: analyses every .game file directly inside dir (subdirectories are
+// not searched) on all cores, writes one CSV row per game to csvPath and prints
+// summary statistics.
+int AnalyzeProcess(std::string dir, std::string csvPath) {
+    auto start = high_resolution_clock::now();
+    std::vector<std::string> files;
+    std::error_code error;
+    std::filesystem::directory_iterator it(dir, error);
+    for (; !error && it != std::filesystem::directory_iterator(); it.increment(error))
+        if (it->path().extension() == ".game")
+            files.push_back(it->path().string());
+    if (error) {
+        std::cerr << "Error: " << dir << " cannot be read" << std::endl;
+        return 1;
+    }
+    sort(files.begin(), files.end());
+
+    std::vector<GameMetrics> metrics(files.size());
+    const char MALFORMED = 0, ANALYSED = 1, UNREADABLE = 2;
+    std::vector<char> status(files.size(), MALFORMED);
+    std::atomic<size_t> next(0);
+    const size_t CHUNK = 256;
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; t++)
+        workers.emplace_back([&]() {
+            GameLog log;
+            std::vector<char> buffer(1 << 16);
+            std::vector<int> number, stack;
+            std::vector<char> covered;
+            while (true) {
+                size_t first = next.fetch_add(CHUNK);
+                if (first >= files.size()) break;
+                size_t last = std::min(first + CHUNK, files.size());
+                for (size_t i = first; i < last; i++) {
+                    std::FILE *f = std::fopen(files[i].c_str(), "rb");
+                    if (!f) {
+                        status[i] = UNREADABLE;
+                        continue;
+                    }
+                    size_t size = 0, got;
+                    while ((got = std::fread(buffer.data() + size, 1, buffer.size() - size, f)) > 0)
+                        if ((size += got) == buffer.size())
+                            buffer.resize(buffer.size() * 2);
+                    std::fclose(f);
+                    // One bad file must not take the whole batch down with it.
+                    try {
+                        if (!log.parse(buffer.data(), buffer.data() + size))
+                            continue;
+                        metrics[i].file = std::filesystem::path(files[i]).filename().string();
+                        AnalyzeGame(log, number, covered, stack, metrics[i]);
+                        status[i] = ANALYSED;
+                    } catch (const std::exception &) {
+                    }
+                }
+            }
+        });
+    for (auto &worker : workers)
+        worker.join();
+
+    std::ofstream os;
+    os.open(csvPath);
+    if (!os) {
+        std::cerr << "Error: " << csvPath << " cannot be written" << std::endl;
+        return 1;
+    }
+    os << "file,width,height,mines,won,seconds,clicks,3bv,openings,3bv_per_s,clicks_per_3bv\n";
+    int analysed = 0, won = 0;
+    double sumBbbv = 0, sumOpenings = 0;
+    std::vector<double> bbbvPerSecond, clicksPerBbbvWon;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (status[i] == UNREADABLE) {
+            std::cerr << "Skipped unreadable file " << files[i] << std::endl;
+            continue;
+        }
+        if (status[i] == MALFORMED) {
+            std::cerr << "Skipped malformed game " << files[i] << std::endl;
+            continue;
+        }
+        GameMetrics &m = metrics[i];
+        // Efficiency only means something for boards that were actually cleared.
+        double speed = (m.won && m.seconds > 0) ? m.bbbv / m.seconds : 0;
+        double clicksPerBbbv = (m.won && m.bbbv) ? (double)m.clicks / m.bbbv : 0;
+        os << m.file << ',' << m.numCol << ',' << m.numRow << ',' << m.numMine << ',' << m.won << ','
+           << m.seconds << ',' << m.clicks << ',' << m.bbbv << ',' << m.openings << ','
+           << speed << ',' << clicksPerBbbv << '\n';
+        analysed++;
+        sumBbbv += m.bbbv;
+        sumOpenings += m.openings;
+        if (m.won) {
+            won++;
+            if (m.seconds > 0)
+                bbbvPerSecond.push_back(speed);
+            if (m.bbbv)
+                clicksPerBbbvWon.push_back(clicksPerBbbv);
+        }
+    }
+    os.close();
+
+    double elapsed = duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+    std::cout << "Games analysed: " << analysed << " (" << files.size() - analysed << " skipped)\n";
+    if (analysed) {
+        std::cout << "Won: " << won << " (" << 100.0 * won / analysed << "%)\n";
+        std::cout << "Mean 3BV: " << sumBbbv / analysed << "\n";
+        std::cout << "Mean openings: " << sumOpenings / analysed << "\n";
+    }
+    if (clicksPerBbbvWon.size()) {
+        double sum = std::accumulate(clicksPerBbbvWon.begin(), clicksPerBbbvWon.end(), 0.0);
+        std::cout << "Mean clicks/3BV (won games): " << sum / clicksPerBbbvWon.size() << "\n";
+    }
+    if (bbbvPerSecond.size()) {
+        sort(bbbvPerSecond.begin(), bbbvPerSecond.end());
+        double sum = std::accumulate(bbbvPerSecond.begin(), bbbvPerSecond.end(), 0.0);
+        std::cout << "3BV/s (won games): mean " << sum / bbbvPerSecond.size()
+                  << ", median " << bbbvPerSecond[bbbvPerSecond.size() / 2]
+                  << ", best " << bbbvPerSecond.back() << "\n";
+    }
+    std::cout << "Took " << elapsed << "s on " << numThreads << " threads ("
+              << (elapsed > 0 ? files.size() / elapsed : 0) << " games/s)" << std::endl;
+    return 0;
+}
+
+// Headless mode: replays a recorded game and writes one numbered PNG per move
+// (frame_000000.png is the untouched board) into outDir, ready for e.g.
+//   ffmpeg -framerate 2 -i frame_%06d.png replay.mp4
+// The main thread rasterizes frames while a pool of workers encodes them; the
+// queue is bounded so rendering never runs far ahead of encoding.
+int RenderProcess(std::string gamePath, std::string outDir) {
+    std::ifstream is(gamePath, std::ios::binary);
+    std::string text((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    GameLog log;
+    if (!is || !log.parse(text.data(), text.data() + text.size())) {
+        std::cerr << "Error: " << gamePath << " is not a recorded game" << std::endl;
+        return 1;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(outDir, error);
+    if (error) {
+        std::cerr << "Error: " << outDir << " cannot be created" << std::endl;
+        return 1;
+    }
+
+    auto start = high_resolution_clock::now();
+    int numThreads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t MAX_QUEUED = 2 * numThreads;
+    std::deque<std::pair<int, sf::Image>> queue;
+    std::mutex mutex;
+    std::condition_variable queueChanged;
+    bool rendering = true;
+    std::atomic<int> failed(0);
+
+    std::vector<std::thread> encoders;
+    for (int t = 0; t < numThreads; t++)
+        encoders.emplace_back([&]() {
+            char name[32];
+            while (true) {
+                std::unique_lock<std::mutex> lock(mutex);
+                queueChanged.wait(lock, [&]() { return !queue.empty() || !rendering; });
+                if (queue.empty()) return;
+                std::pair<int, sf::Image> item = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                queueChanged.notify_all();
+                std::snprintf(name, sizeof(name), "/frame_%06d.png", item.first);
+                if (!item.second.saveToFile(outDir + name))
+                    failed++;
+            }
+        });
+
+    ImageTarget target;
+    boardMap state(log.numCol, log.numRow, log.numMine);
+    state.LoadMineMap(log.mines);
+    Board game(state);
+    game.init();
+    game.setReplayTime(0);
+    int frames = log.actions.size() + 1;
+    for (int f = 0; f < frames; f++) {
+        if (f > 0)
+            game.replay(log.actions[f - 1]);
+        game.PrintBoard(target);
+        std::unique_lock<std::mutex> lock(mutex);
+        queueChanged.wait(lock, [&]() { return queue.size() < MAX_QUEUED; });
+        queue.emplace_back(f, target.frame);
+        lock.unlock();
+        queueChanged.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rendering = false;
+    }
+    queueChanged.notify_all();
+    for (auto &encoder : encoders)
+        encoder.join();
+
+    double elapsed = duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+    std::cout << "Wrote " << frames - failed << " frames to " << outDir << " in " << elapsed << "s on "
+              << numThreads << " encoder threads" << std::endl;
+    if (failed) {
+        std::cerr << "Error: " << failed << " frames cannot be written" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int LeaderboardWindowProcess(const Assets &assets, int width, int height, int time = -10, std::string playerName = "") {
     width /= 2;
     height /= 2;
     sf::RenderWindow window(sf::VideoMode(width, height), "Leaderboard Window");
     window.setFramerateLimit(60);
-    sf::Font font;
-    if (!font.loadFromFile("font.ttf")) {
-        std::cerr << "Error: font.ttf cannot be loaded" << std::endl;
-        return 1;
-    }
+    const sf::Font &font = assets.font;
     sf::Text title;
     title.setStyle(sf::Text::Bold | sf::Text::Underlined);
     title.setFillColor(sf::Color::White);
@@ -598,23 +1312,30 @@ int LeaderboardWindowProcess(int width, int height, int time = -10, std::string
     return 0;
 }
 
-int GameWindowProcess(std::string playerName) {
+int GameWindowProcess(std::string playerName, const Assets &assets) {
     int numRow, numCol, numMine;
     LoadBoardConfig(numCol, numRow, numMine);
-    int width = numCol * 32;
-    int heigh = numRow * 32 + 100;
+    sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+    int viewRows = std::min(numRow, ((int)desktop.height - SCREEN_MARGIN - 100) / 32);
+    int viewCols = std::min(numCol, ((int)desktop.width - SCREEN_MARGIN) / 32);
+    // A board that does not fit gets a minimap column on the right.
+    int minimapColumn = 0;
+    if (viewCols < numCol || viewRows < numRow) {
+        minimapColumn = MINIMAP_SIZE + 2 * MINIMAP_MARGIN;
+        viewCols = std::min(numCol, ((int)desktop.width - SCREEN_MARGIN - minimapColumn) / 32);
+    }
+    int width = viewCols * 32 + minimapColumn;
+    int heigh = viewRows * 32 + 100;
     sf::RenderWindow window(sf::VideoMode(width, heigh), "Game Window");
     window.setFramerateLimit(60);
-    sf::Font font;
-    if (!font.loadFromFile("font.ttf")) {
-        std::cerr << "Error: font.ttf cannot be loaded" << std::endl;
-        return 1;
-    }
     
     boardMap state(numCol, numRow, numMine);
     state.RandomMineMap();
-    Board game(state, playerName);
+    Board game(state, playerName, assets);
+    game.setViewSize(viewCols, viewRows);
     game.init();
+    // Touchpads send fractions of a notch; keep the remainder until it adds up to a cell.
+    float wheelCols = 0, wheelRows = 0;
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -629,13 +1350,14 @@ int GameWindowProcess(std::string playerName) {
                 // Print the mouse position to the console
                 // std::cout << "Left click at position: " << mousePosition.x << ", " << mousePosition.y << std::endl;
                 game.openCell(mousePosition.x, mousePosition.y);
+                game.minimapJump(mousePosition.x, mousePosition.y);
                 game.debug(mousePosition.x, mousePosition.y);
                 game.face(mousePosition.x, mousePosition.y);
                 game.pause(mousePosition.x, mousePosition.y);
                 if (game.leaderboard(mousePosition.x, mousePosition.y)) {
                     game.pause(-1, -1, 1);
                     game.PrintBoard(window);
-                    LeaderboardWindowProcess(window.getSize().x, window.getSize().y);
+                    LeaderboardWindowProcess(assets, window.getSize().x, window.getSize().y);
                     game.pause(-1, -1, 1);
                 }
             }
@@ -646,22 +1368,41 @@ int GameWindowProcess(std::string playerName) {
                 game.setFlag(mousePosition.x, mousePosition.y);
 
             }
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::Left) game.scroll(-1, 0);
+                if (event.key.code == sf::Keyboard::Right) game.scroll(1, 0);
+                if (event.key.code == sf::Keyboard::Up) game.scroll(0, -1);
+                if (event.key.code == sf::Keyboard::Down) game.scroll(0, 1);
+            }
+            if (event.type == sf::Event::MouseWheelScrolled) {
+                float &wheel = (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel) ? wheelRows : wheelCols;
+                wheel -= 3 * event.mouseWheelScroll.delta;
+                int steps = wheel;
+                wheel -= steps;
+                if (event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel)
+                    game.scroll(0, steps);
+                else
+                    game.scroll(steps, 0);
+            }
         }
         game.PrintBoard(window);
     }
     return 0;
 }
 
-int main() {
+int main(int argc, char **argv) {
+    if (argc >= 3 && std::string(argv[1]) == "--analyze")
+        return AnalyzeProcess(argv[2], argc >= 4 ? argv[3] : "analysis.csv");
+    if (argc >= 4 && std::string(argv[1]) == "--render")
+        return RenderProcess(argv[2], argv[3]);
 
     sf::RenderWindow window(sf::VideoMode(800, 600), "Welcome Window");
     window.setFramerateLimit(60);
+    startupTimer.mark("window");
 
-    sf::Font font;
-    if (!font.loadFromFile("font.ttf")) {
-        std::cerr << "Error: font.ttf cannot be loaded" << std::endl;
-        return 1;
-    }
+    Assets assets;
+    const sf::Font &font = assets.font;
+    startupTimer.mark("assets");
 
     sf::Text welcomeText;
     welcomeText.setFont(font);
@@ -737,10 +1478,11 @@ int main() {
         window.draw(playerNameText);
         window.draw(cursor);
         window.display();
+        startupTimer.finish();
     }
 
     // Proceed to game window
     // ...
-    GameWindowProcess(playerName);
+    GameWindowProcess(playerName, assets);
     return 0;
 }
\ No newline at end of file